@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// Big-endian helpers, same byte order as the Huffman header in kolesnikov.cpp.
+
+inline void putU32(std::string& out, uint32_t value) {
+    out += static_cast<char>((value >> 24) & 0xFF);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>(value & 0xFF);
+}
+
+inline uint32_t getU32(const std::string& data, size_t pos) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(data[pos])) << 24) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 1])) << 16) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 2])) << 8) |
+        static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 3]));
+}
+
+inline void putU64(std::string& out, uint64_t value) {
+    putU32(out, static_cast<uint32_t>(value >> 32));
+    putU32(out, static_cast<uint32_t>(value & 0xFFFFFFFFu));
+}
+
+inline uint64_t getU64(const std::string& data, size_t pos) {
+    return (static_cast<uint64_t>(getU32(data, pos)) << 32) | getU32(data, pos + 4);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Hot-path counters for the codecs. Compiled in only when SJATIE_STATS is
+// defined; otherwise every STATS_* macro expands to nothing.
+// Codecs count into locals and publish once per call, so an enabled build
+// pays a handful of relaxed atomic adds per encode, not per byte.
+
+const int STATS_HIST_BUCKETS = 17; // bucket 0 holds 0, bucket k holds [2^(k-1), 2^k), last is open
+
+inline int statsBucket(uint64_t value) {
+    int bucket = 0;
+    while (value && bucket < STATS_HIST_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+struct LocalHistogram {
+    uint64_t buckets[STATS_HIST_BUCKETS] = {};
+
+    void add(uint64_t value) { buckets[statsBucket(value)]++; }
+};
+
+struct StatsHistogram {
+    std::atomic<uint64_t> buckets[STATS_HIST_BUCKETS];
+
+    void merge(const LocalHistogram& local) {
+        for (int i = 0; i < STATS_HIST_BUCKETS; i++) {
+            if (local.buckets[i]) buckets[i].fetch_add(local.buckets[i], std::memory_order_relaxed);
+        }
+    }
+};
+
+struct CodecStats {
+    // LZ77 match finder (milyaeva.cpp)
+    StatsHistogram lz77_match_length;
+    StatsHistogram lz77_match_offset;
+    std::atomic<uint64_t> lz77_searches;
+    std::atomic<uint64_t> lz77_chain_steps;
+
+    // LZW dictionary (litvinova.cpp)
+    std::atomic<uint64_t> lzw_calls;
+    std::atomic<uint64_t> lzw_codes;
+    std::atomic<uint64_t> lzw_dict_entries;     // final fill, summed over calls
+    std::atomic<uint64_t> lzw_dict_full_events; // calls that hit the 65536-entry cap and froze
+
+    // Huffman (kolesnikov.cpp)
+    std::atomic<uint64_t> huffman_symbols;
+    std::atomic<uint64_t> huffman_code_bits;
+    std::atomic<uint64_t> huffman_entropy_millibits; // order-0 entropy * symbols * 1000
+
+    // Word RLE (doni.cpp)
+    StatsHistogram rle_run_length;
+};
+
+CodecStats& codec_stats();
+void codec_stats_reset();
+std::string codec_stats_json();
+
+#ifdef SJATIE_STATS
+#define STATS_ADD(field, value) (codec_stats().field.fetch_add(static_cast<uint64_t>(value), std::memory_order_relaxed))
+#define STATS_MERGE(field, local) (codec_stats().field.merge(local))
+#define STATS_ONLY(...) __VA_ARGS__
+#else
+#define STATS_ADD(field, value) ((void)0)
+#define STATS_MERGE(field, local) ((void)0)
+#define STATS_ONLY(...)
+#endif
\ No newline at end of file
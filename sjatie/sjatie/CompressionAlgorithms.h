@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
 
 struct CompressionResult {
     std::string algorithm_name;
@@ -11,14 +14,128 @@ struct CompressionResult {
     bool integrity_ok;
 };
 
+// CRC32C (Castagnoli). See crc32c.cpp.
+uint32_t crc32c(const std::string& data);
+uint32_t crc32c_update(uint32_t crc, const char* data, size_t len);
+
+// The *_decompress functions below take the bare codec payload; checksum_encode
+// and the containers further down add and verify the CRC.
+
 CompressionResult kolesnikov_compress(const std::string& input);
-std::string kolesnikov_decompress(const std::string& compressed);
+std::string kolesnikov_encode(const std::string& input);
+// Returns "" when the header declares more than max_symbols symbols.
+std::string kolesnikov_decompress(const std::string& compressed, size_t max_symbols = SIZE_MAX);
 
 CompressionResult litvinova_compress(const std::string& input);
+std::string litvinova_encode(const std::string& input);
 std::string litvinova_decompress(const std::string& compressed);
 
 CompressionResult milyaeva_compress(const std::string& input);
+std::string milyaeva_encode(const std::string& input);
 std::string milyaeva_decompress(const std::string& compressed);
 
 CompressionResult doni_compress(const std::string& input);
-std::string doni_decompress(const std::string& compressed);
\ No newline at end of file
+std::string doni_encode(const std::string& input);
+std::string doni_decompress(const std::string& compressed);
+
+CompressionResult bwt_compress(const std::string& input);
+std::string bwt_encode(const std::string& input, size_t block_size = 1 << 20, unsigned threads = 0);
+std::string bwt_decompress(const std::string& compressed, bool* checksum_ok = nullptr);
+
+// Codec ids stored in front of every block of the per-block formats.
+enum CodecId : unsigned char {
+    CODEC_STORED = 0,
+    CODEC_HUFFMAN = 1,
+    CODEC_LZW = 2,
+    CODEC_LZ77 = 3,
+    CODEC_RLE = 4,
+    CODEC_BWT = 5,
+    CODEC_COUNT,
+    // Not stored: asks encode_block_record to pick the codec per block.
+    CODEC_AUTO = 0x7F
+};
+
+const char* codec_name(CodecId id);
+std::string codec_encode(CodecId id, const std::string& block);
+std::string codec_decode(CodecId id, const std::string& payload);
+
+// Checked single-codec frame used by the *_compress functions:
+//   [codec id | 0x80 if checksummed][payload][crc32c u32 of the input, if flagged]
+// checksum_decode returns "" when the id is unknown or the CRC does not match.
+std::string checksum_encode(CodecId id, const std::string& input, bool with_checksum = true);
+std::string checksum_decode(const std::string& framed, bool* checksum_ok = nullptr);
+
+struct BlockEstimate {
+    double entropy_bits;      // order-0 entropy, bits per byte
+    double repeat_word_rate;  // share of words equal to the previous word
+    double match_density;     // share of sampled bytes covered by hash-probe matches
+    double avg_match_length;
+    size_t distinct_symbols;
+    bool rle_safe;            // word RLE would round-trip this block
+};
+
+BlockEstimate estimate_block(const std::string& block);
+CodecId choose_codec(const BlockEstimate& estimate, size_t block_size, double min_throughput_mb_s);
+
+CompressionResult auto_compress(const std::string& input, size_t block_size = 65536, double min_throughput_mb_s = 0.0);
+std::string auto_encode(const std::string& input, size_t block_size = 65536, double min_throughput_mb_s = 0.0, bool with_checksum = true);
+std::string auto_decompress(const std::string& compressed, bool* checksum_ok = nullptr);
+
+// A single block of the auto container:
+// [codec id | checksum flag][raw_len u32][payload_len u32][crc32c u32, if flagged][payload].
+// Records can be concatenated and decoded with auto_decompress.
+const size_t BLOCK_RECORD_HEADER_SIZE = 9;
+// Largest raw block or payload a record may declare.
+const size_t MAX_BLOCK_SIZE = 0x7FFFFFFF;
+// Codec selection shared by every block format: resolves CODEC_AUTO, and falls back
+// to stored when RLE would lose whitespace or the payload is not smaller. Returns
+// the codec actually used; payload receives its output.
+CodecId encode_block_payload(const std::string& block, CodecId codec, double min_throughput_mb_s, std::string& payload);
+std::string encode_block_record(const std::string& block, CodecId codec, double min_throughput_mb_s, bool with_checksum);
+// Serializes a record around an already coded payload; crc is used only with with_checksum.
+std::string make_block_record(CodecId id, size_t raw_len, const std::string& payload, bool with_checksum, uint32_t crc);
+// Full record size given its first BLOCK_RECORD_HEADER_SIZE bytes, 0 if a length exceeds MAX_BLOCK_SIZE.
+size_t block_record_size(const std::string& header);
+
+// Seekable archive: independent blocks plus a trailing index, so a byte
+// range can be read without decoding the whole payload. See seekable.cpp.
+CompressionResult seekable_compress(const std::string& input, CodecId codec, size_t block_size = 65536);
+std::string seekable_encode(const std::string& input, CodecId codec, size_t block_size = 65536);
+std::string seekable_read_range(const std::string& archive, uint64_t offset, size_t len);
+std::string seekable_read_range_file(const std::string& filename, uint64_t offset, size_t len);
+uint64_t seekable_size(const std::string& archive);
+std::string seekable_decompress(const std::string& archive);
+
+// Reversible preprocessing filters applied to each block before the codec.
+// See filters.cpp. filter_revert returns "" on malformed input.
+enum FilterId : unsigned char {
+    FILTER_COLUMNS = 1, // split delimited lines into per-column streams
+    FILTER_DELTA = 2,   // numbers as zig-zag varint deltas within their column
+    FILTER_E8E9 = 3,    // x86 call/jump displacements made absolute
+    FILTER_COUNT
+};
+const size_t MAX_FILTER_CHAIN = 8;
+
+const char* filter_name(FilterId filter);
+std::string filter_apply(FilterId filter, const std::string& input);
+std::string filter_revert(FilterId filter, const std::string& data);
+std::string filter_chain_apply(const std::vector<FilterId>& chain, const std::string& input);
+std::string filter_chain_revert(const std::vector<FilterId>& chain, const std::string& data);
+bool parse_filter_chain(const std::string& names, std::vector<FilterId>& chain); // e.g. "delta,columns"
+
+// Streaming compressor used by the command line: reader, worker pool and
+// ordered writer connected by bounded queues. See pipeline.cpp.
+struct PipelineOptions {
+    CodecId codec;              // a fixed codec or CODEC_AUTO
+    double min_throughput_mb_s; // budget for CODEC_AUTO
+    size_t block_size;
+    unsigned threads;           // 0 = hardware concurrency
+    bool with_checksum;
+    std::vector<FilterId> filters; // applied in order, recorded in the stream header
+};
+
+bool pipeline_compress(std::istream& in, std::ostream& out, const PipelineOptions& options);
+bool pipeline_decompress(std::istream& in, std::ostream& out, unsigned threads);
+
+// Filter chain in front of a codec, round-tripped through the pipeline format.
+CompressionResult filtered_compress(const std::string& input, const std::vector<FilterId>& chain, CodecId codec = CODEC_AUTO);
\ No newline at end of file
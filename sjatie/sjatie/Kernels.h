@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Inner loops of the codecs, declared here so microbench.cpp can time them
+// one by one. They are not part of the codec API in CompressionAlgorithms.h.
+
+struct LZ77Triple {
+    unsigned short offset;
+    unsigned char length;
+    char next_char;
+
+    LZ77Triple(unsigned short o = 0, unsigned char l = 0, char c = 0) : offset(o), length(l), next_char(c) {}
+};
+
+// milyaeva.cpp: brute-force LZ77 match search
+LZ77Triple findLongestMatch(const std::string& input, size_t current_pos, size_t search_buffer_size, size_t look_ahead_buffer_size);
+
+// litvinova.cpp: LZW dictionary walk and variable-width code packing
+std::vector<int> lzw_build_codes(const std::string& s);
+std::string lzw_compress_binary(const std::string& s);
+std::string codesToBinaryString(const std::vector<int>& codes, int initialCodeSize);
+std::vector<int> binaryStringToCodes(const std::string& binary_str, int initialCodeSize);
+
+// kolesnikov.cpp: Huffman bit packing
+std::string bitsToBytes(const std::string& bits);
+std::string bytesToBits(const std::string& bytes, size_t originalBitLength);
+
+// doni.cpp: word tokenizer of the RLE codec
+std::vector<std::string> splitIntoWords(const std::string& text);
\ No newline at end of file
@@ -0,0 +1,389 @@
+#include "CompressionAlgorithms.h"
+#include "ByteIO.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Block-sorting codec in the spirit of bzip2: BWT -> move-to-front ->
+// zero-run RLE -> Huffman (kolesnikov_encode). Blocks are independent and
+// are sorted on separate threads. Like bzip2, every block carries the CRC32C
+// of its raw bytes, checked as soon as that block is decoded.
+
+// Zero runs are written in bijective base 2 with RUNA/RUNB digits, other MTF
+// ranks are shifted by one. Ranks 254 and 255 do not fit and are escaped.
+static const unsigned char RUNA = 0;
+static const unsigned char RUNB = 1;
+static const unsigned char RANK_ESCAPE = 255;
+
+// SA-IS suffix array construction, linear in the block size.
+// Values of s are in [0, upper]; the empty suffix sorts first implicitly.
+static std::vector<int> suffixArray(const std::vector<int>& s, int upper) {
+    int n = static_cast<int>(s.size());
+    if (n == 0) return std::vector<int>();
+    if (n == 1) return std::vector<int>(1, 0);
+    if (n == 2) {
+        std::vector<int> two(2);
+        two[0] = s[0] < s[1] ? 0 : 1;
+        two[1] = 1 - two[0];
+        return two;
+    }
+
+    std::vector<int> sa(n);
+    std::vector<bool> ls(n);
+    for (int i = n - 2; i >= 0; i--) {
+        ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    std::vector<int> sum_l(upper + 1), sum_s(upper + 1);
+    for (int i = 0; i < n; i++) {
+        if (!ls[i]) sum_s[s[i]]++;
+        else sum_l[s[i] + 1]++;
+    }
+    for (int i = 0; i <= upper; i++) {
+        sum_s[i] += sum_l[i];
+        if (i < upper) sum_l[i + 1] += sum_s[i];
+    }
+
+    auto induce = [&](const std::vector<int>& lms) {
+        std::fill(sa.begin(), sa.end(), -1);
+        std::vector<int> buf(sum_s);
+        for (int d : lms) {
+            if (d == n) continue;
+            sa[buf[s[d]]++] = d;
+        }
+        buf = sum_l;
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; i++) {
+            int v = sa[i];
+            if (v >= 1 && !ls[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+        }
+        buf = sum_l;
+        for (int i = n - 1; i >= 0; i--) {
+            int v = sa[i];
+            if (v >= 1 && ls[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    std::vector<int> lms_map(n + 1, -1);
+    std::vector<int> lms;
+    for (int i = 1; i < n; i++) {
+        if (!ls[i - 1] && ls[i]) {
+            lms_map[i] = static_cast<int>(lms.size());
+            lms.push_back(i);
+        }
+    }
+    int m = static_cast<int>(lms.size());
+
+    induce(lms);
+
+    if (m) {
+        std::vector<int> sorted_lms;
+        sorted_lms.reserve(m);
+        for (int v : sa) {
+            if (lms_map[v] != -1) sorted_lms.push_back(v);
+        }
+
+        // Name the LMS substrings and sort them recursively if names repeat.
+        std::vector<int> rec_s(m);
+        int rec_upper = 0;
+        rec_s[lms_map[sorted_lms[0]]] = 0;
+        for (int i = 1; i < m; i++) {
+            int l = sorted_lms[i - 1], r = sorted_lms[i];
+            int end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+            int end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+            bool same = true;
+            if (end_l - l != end_r - r) {
+                same = false;
+            }
+            else {
+                while (l < end_l && s[l] == s[r]) {
+                    l++;
+                    r++;
+                }
+                if (l == n || s[l] != s[r]) same = false;
+            }
+            if (!same) rec_upper++;
+            rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+        }
+
+        std::vector<int> rec_sa = suffixArray(rec_s, rec_upper);
+        for (int i = 0; i < m; i++) {
+            sorted_lms[i] = lms[rec_sa[i]];
+        }
+        induce(sorted_lms);
+    }
+    return sa;
+}
+
+// BWT of block + implicit sentinel. The sentinel row is dropped from the
+// output and its position is returned in primary.
+static std::string bwtForward(const std::string& block, uint32_t& primary) {
+    std::vector<int> s(block.size());
+    for (size_t i = 0; i < block.size(); i++) {
+        s[i] = static_cast<unsigned char>(block[i]);
+    }
+    std::vector<int> sa = suffixArray(s, 255);
+
+    std::string last;
+    last.reserve(block.size());
+    // Row 0 is the sentinel suffix, preceded by the last byte of the block.
+    last += block.back();
+    primary = 0;
+    for (size_t i = 0; i < sa.size(); i++) {
+        if (sa[i] == 0) {
+            primary = static_cast<uint32_t>(i + 1);
+        }
+        else {
+            last += block[sa[i] - 1];
+        }
+    }
+    return last;
+}
+
+static std::string bwtInverse(const std::string& last, uint32_t primary) {
+    size_t n = last.size();
+    if (n == 0 || primary == 0 || primary > n) return "";
+
+    // Last-column symbol of a row in the full (n + 1)-row matrix.
+    auto symbolAt = [&](size_t row) {
+        return static_cast<unsigned char>(last[row < primary ? row : row - 1]);
+    };
+
+    size_t count[256] = { 0 };
+    for (unsigned char c : last) count[c]++;
+    size_t first[256];
+    size_t sum = 1; // row 0 starts with the sentinel
+    for (int c = 0; c < 256; c++) {
+        first[c] = sum;
+        sum += count[c];
+    }
+
+    std::vector<uint32_t> lf(n + 1, 0);
+    for (size_t row = 0; row <= n; row++) {
+        if (row == primary) continue;
+        lf[row] = static_cast<uint32_t>(first[symbolAt(row)]++);
+    }
+
+    std::string block(n, '\0');
+    size_t row = 0;
+    for (size_t i = n; i > 0; i--) {
+        block[i - 1] = static_cast<char>(symbolAt(row));
+        row = lf[row];
+    }
+    return block;
+}
+
+static std::string mtfRleEncode(const std::string& data) {
+    unsigned char order[256];
+    for (int i = 0; i < 256; i++) order[i] = static_cast<unsigned char>(i);
+
+    std::string out;
+    out.reserve(data.size());
+    size_t zero_run = 0;
+
+    auto flushRun = [&]() {
+        // Bijective base 2: digits 1 and 2 written as RUNA and RUNB.
+        while (zero_run > 0) {
+            if (zero_run & 1) {
+                out += static_cast<char>(RUNA);
+                zero_run = (zero_run - 1) / 2;
+            }
+            else {
+                out += static_cast<char>(RUNB);
+                zero_run = (zero_run - 2) / 2;
+            }
+        }
+    };
+
+    for (unsigned char c : data) {
+        int rank = 0;
+        while (order[rank] != c) rank++;
+        if (rank == 0) {
+            zero_run++;
+            continue;
+        }
+        flushRun();
+        std::memmove(order + 1, order, rank);
+        order[0] = c;
+
+        if (rank < 254) {
+            out += static_cast<char>(rank + 1);
+        }
+        else {
+            out += static_cast<char>(RANK_ESCAPE);
+            out += static_cast<char>(rank);
+        }
+    }
+    flushRun();
+    return out;
+}
+
+// Returns "" as soon as the output would grow past max_len, so a corrupt run
+// cannot double its way to gigabytes.
+static std::string mtfRleDecode(const std::string& data, size_t max_len) {
+    unsigned char order[256];
+    for (int i = 0; i < 256; i++) order[i] = static_cast<unsigned char>(i);
+
+    std::string out;
+    size_t zero_run = 0;
+    size_t digit = 1;
+
+    for (size_t pos = 0; pos < data.size(); pos++) {
+        unsigned char sym = static_cast<unsigned char>(data[pos]);
+        if (sym == RUNA || sym == RUNB) {
+            zero_run += (sym == RUNA ? 1 : 2) * digit;
+            if (zero_run > max_len - out.size()) return "";
+            digit <<= 1;
+            continue;
+        }
+        if (out.size() + zero_run >= max_len) return "";
+        if (zero_run > 0) {
+            out.append(zero_run, static_cast<char>(order[0]));
+            zero_run = 0;
+            digit = 1;
+        }
+
+        int rank;
+        if (sym == RANK_ESCAPE) {
+            if (++pos >= data.size()) return "";
+            rank = static_cast<unsigned char>(data[pos]);
+        }
+        else {
+            rank = sym - 1;
+        }
+        unsigned char c = order[rank];
+        std::memmove(order + 1, order, rank);
+        order[0] = c;
+        out += static_cast<char>(c);
+    }
+    if (zero_run > 0) {
+        out.append(zero_run, static_cast<char>(order[0]));
+    }
+    return out;
+}
+
+static std::string encodeBlock(const std::string& block) {
+    uint32_t primary = 0;
+    std::string last = bwtForward(block, primary);
+    std::string out;
+    putU32(out, primary);
+    out += kolesnikov_encode(mtfRleEncode(last));
+    return out;
+}
+
+static std::string decodeBlock(const std::string& payload, size_t raw_len) {
+    if (payload.size() < 4) return "";
+    uint32_t primary = getU32(payload, 0);
+    // Escaped ranks take two symbols per byte, so no valid block needs more than 2 * raw_len.
+    std::string symbols = kolesnikov_decompress(payload.substr(4), 2 * raw_len);
+    std::string last = mtfRleDecode(symbols, raw_len);
+    if (last.size() != raw_len) return "";
+    return bwtInverse(last, primary);
+}
+
+std::string bwt_encode(const std::string& input, size_t block_size, unsigned threads) {
+    if (block_size == 0) block_size = 1 << 20;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    size_t block_count = (input.size() + block_size - 1) / block_size;
+    std::vector<std::string> payloads(block_count);
+    std::vector<uint32_t> crcs(block_count);
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads && t < block_count; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t b = t; b < block_count; b += threads) {
+                std::string block = input.substr(b * block_size, block_size);
+                crcs[b] = crc32c(block);
+                payloads[b] = encodeBlock(block);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    std::string out;
+    for (size_t b = 0; b < block_count; b++) {
+        size_t raw_len = std::min(block_size, input.size() - b * block_size);
+        putU32(out, static_cast<uint32_t>(raw_len));
+        putU32(out, static_cast<uint32_t>(payloads[b].size()));
+        putU32(out, crcs[b]);
+        out += payloads[b];
+    }
+    return out;
+}
+
+std::string bwt_decompress(const std::string& compressed, bool* checksum_ok) {
+    std::vector<std::pair<size_t, size_t>> blocks;
+    std::vector<uint32_t> raw_lengths;
+    std::vector<uint32_t> crcs;
+    if (checksum_ok) *checksum_ok = false;
+    size_t pos = 0;
+    while (pos < compressed.size()) {
+        if (pos + 12 > compressed.size()) return "";
+        uint32_t raw_len = getU32(compressed, pos);
+        uint32_t payload_len = getU32(compressed, pos + 4);
+        crcs.push_back(getU32(compressed, pos + 8));
+        pos += 12;
+        if (raw_len > MAX_BLOCK_SIZE || pos + payload_len > compressed.size()) return "";
+        blocks.push_back(std::make_pair(pos, static_cast<size_t>(payload_len)));
+        raw_lengths.push_back(raw_len);
+        pos += payload_len;
+    }
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> decoded(blocks.size());
+    std::vector<char> block_ok(blocks.size(), 0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads && t < blocks.size(); t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t b = t; b < blocks.size(); b += threads) {
+                // An exception escaping this thread would terminate the process;
+                // a block that throws is just a bad block.
+                try {
+                    decoded[b] = decodeBlock(compressed.substr(blocks[b].first, blocks[b].second), raw_lengths[b]);
+                    block_ok[b] = decoded[b].size() == raw_lengths[b] && crc32c(decoded[b]) == crcs[b];
+                }
+                catch (...) {
+                    decoded[b].clear();
+                    block_ok[b] = 0;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    std::string result;
+    for (size_t b = 0; b < decoded.size(); b++) {
+        if (!block_ok[b]) return "";
+        result += decoded[b];
+    }
+    if (checksum_ok) *checksum_ok = true;
+    return result;
+}
+
+CompressionResult bwt_compress(const std::string& input) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::string compressed_data = bwt_encode(input);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto compression_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    auto decomp_start = std::chrono::high_resolution_clock::now();
+    bool checksum_ok = false;
+    std::string decompressed = bwt_decompress(compressed_data, &checksum_ok);
+    auto decomp_end = std::chrono::high_resolution_clock::now();
+    auto decompression_time = std::chrono::duration_cast<std::chrono::microseconds>(decomp_end - decomp_start);
+
+    CompressionResult result;
+    result.algorithm_name = "BWT+MTF+RLE+Huffman";
+    result.original_size = input.size();
+    result.compressed_size = compressed_data.size();
+    result.compression_ratio = compressed_data.empty() ? 1.0 : static_cast<double>(input.size()) / compressed_data.size();
+    result.compression_time_ms = static_cast<double>(compression_time.count()) / 1000.0;
+    result.decompression_time_ms = static_cast<double>(decompression_time.count()) / 1000.0;
+    result.integrity_ok = checksum_ok;
+
+    return result;
+}
\ No newline at end of file
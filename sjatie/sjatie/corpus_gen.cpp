@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Deterministic benchmark corpus generator. The same profile, size and seed
+// produce the same bytes on every machine: the PRNG and every mapping from
+// random numbers to output are defined here rather than taken from <random>,
+// whose distributions differ between standard libraries.
+//
+//   sjatie_corpus -p profile -s size [-S seed] -o file
+//   sjatie_corpus -a dir -s size [-S seed]      one file per profile
+//
+// Output is streamed in chunks, so multi-GB files need only a few MB of memory.
+
+static const size_t CHUNK_SIZE = 1 << 20;
+
+// splitmix64
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, n); the tiny modulo bias is irrelevant here and portable.
+    uint64_t below(uint64_t n) { return n ? next() % n : 0; }
+
+    // Roughly Zipf-distributed index in [0, n): small indexes are much more common.
+    size_t skewed(size_t n) {
+        double u = static_cast<double>(next() >> 11) / 9007199254740992.0;
+        return static_cast<size_t>(u * u * u * n);
+    }
+
+private:
+    uint64_t state_;
+};
+
+static const char* const WORDS[] = {
+    "the", "of", "and", "to", "in", "a", "is", "that", "for", "it", "as", "was", "with", "be", "by",
+    "on", "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had",
+    "they", "you", "were", "their", "one", "all", "we", "can", "her", "has", "there", "been", "if",
+    "more", "when", "will", "would", "who", "so", "no", "time", "people", "year", "way", "day", "man",
+    "thing", "woman", "life", "child", "world", "school", "state", "family", "student", "group",
+    "country", "problem", "hand", "part", "place", "case", "week", "company", "system", "program",
+    "question", "work", "government", "number", "night", "point", "home", "water", "room", "mother",
+    "area", "money", "story", "fact", "month", "lot", "right", "study", "book", "eye", "job", "word",
+    "business", "issue", "side", "kind", "head", "house", "service", "friend", "father", "power",
+    "hour", "game", "line", "end", "member", "law", "car", "city", "community", "name", "president",
+    "team", "minute", "idea", "kid", "body", "information", "back", "parent", "face", "others",
+    "level", "office", "door", "health", "person", "art", "war", "history", "party", "result",
+    "change", "morning", "reason", "research", "girl", "guy", "moment", "air", "teacher", "force",
+    "education", "compression", "block", "stream", "window", "dictionary", "symbol", "entropy",
+};
+static const size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+static const char* const LEVELS[] = { "INFO", "INFO", "INFO", "INFO", "DEBUG", "DEBUG", "WARN", "ERROR" };
+static const char* const METHODS[] = { "GET", "GET", "GET", "POST", "PUT", "DELETE" };
+static const char* const PATHS[] = {
+    "/api/v1/users", "/api/v1/orders", "/api/v1/items", "/api/v2/search", "/health", "/metrics",
+    "/static/app.js", "/static/style.css", "/login", "/logout",
+};
+static const int STATUSES[] = { 200, 200, 200, 200, 200, 201, 204, 301, 304, 400, 404, 500 };
+
+template <typename T, size_t N>
+static const T& pick(Rng& rng, const T (&items)[N]) {
+    return items[rng.below(N)];
+}
+
+static string pad2(uint64_t value) {
+    char buffer[8];
+    snprintf(buffer, sizeof(buffer), "%02u", static_cast<unsigned>(value % 100));
+    return buffer;
+}
+
+// Each profile appends at least one record to out per call.
+typedef void (*ProfileStep)(Rng& rng, uint64_t& counter, string& out);
+
+static void logsStep(Rng& rng, uint64_t& counter, string& out) {
+    counter += 1 + rng.below(250); // milliseconds since 2024-03-01T00:00:00
+    uint64_t ms = counter % 1000, s = counter / 1000;
+    out += "2024-03-01T" + pad2(s / 3600 % 24) + ":" + pad2(s / 60 % 60) + ":" + pad2(s % 60) + "." +
+        to_string(1000 + ms).substr(1) + "Z ";
+    out += pick(rng, LEVELS);
+    out += " [worker-" + to_string(rng.below(8)) + "] ";
+    out += pick(rng, METHODS);
+    out += ' ';
+    out += pick(rng, PATHS);
+    if (rng.below(2)) out += "/" + to_string(rng.below(100000));
+    // Draw into locals: the order operands of one expression are evaluated in
+    // differs between compilers, and the corpus must not.
+    int status = pick(rng, STATUSES);
+    uint64_t latency = 1 + rng.skewed(2000);
+    out += ' ' + to_string(status) + ' ' + to_string(latency) + "ms req=";
+    static const char HEX[] = "0123456789abcdef";
+    for (int i = 0; i < 8; i++) out += HEX[rng.below(16)];
+    out += '\n';
+}
+
+static void textStep(Rng& rng, uint64_t& counter, string& out) {
+    size_t length = 5 + rng.below(20);
+    for (size_t i = 0; i < length; i++) {
+        string word = WORDS[rng.skewed(WORD_COUNT)];
+        if (i == 0) word[0] = static_cast<char>(toupper(static_cast<unsigned char>(word[0])));
+        out += word;
+        if (i + 1 < length) out += (rng.below(12) == 0) ? ", " : " ";
+    }
+    out += rng.below(8) == 0 ? "?" : ".";
+    out += (++counter % 6 == 0) ? "\n\n" : " ";
+}
+
+static void jsonStep(Rng& rng, uint64_t& counter, string& out) {
+    counter += 1000 + rng.below(50);
+    // One draw per statement, as in logsStep: argument evaluation order is unspecified.
+    unsigned host = static_cast<unsigned>(rng.below(16));
+    unsigned cpu = static_cast<unsigned>(rng.below(100));
+    unsigned cpu_tenths = static_cast<unsigned>(rng.below(10));
+    unsigned mem_mb = static_cast<unsigned>(2048 + rng.below(6144));
+    unsigned temp_c = static_cast<unsigned>(40 + rng.below(40));
+    unsigned temp_tenths = static_cast<unsigned>(rng.below(10));
+    unsigned rps = static_cast<unsigned>(rng.skewed(5000));
+    const char* status = rng.below(20) ? "ok" : "degraded";
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer),
+        "{\"ts\":%llu,\"host\":\"node-%02u\",\"cpu\":%u.%u,\"mem_mb\":%u,\"temp_c\":%u.%u,\"rps\":%u,\"status\":\"%s\"}\n",
+        static_cast<unsigned long long>(1709251200000ull + counter),
+        host, cpu, cpu_tenths, mem_mb, temp_c, temp_tenths, rps, status);
+    out += buffer;
+}
+
+static void randomStep(Rng& rng, uint64_t&, string& out) {
+    for (int i = 0; i < 512; i++) {
+        uint64_t value = rng.next();
+        for (int b = 0; b < 8; b++) out += static_cast<char>((value >> (8 * b)) & 0xFF);
+    }
+}
+
+// Words repeated in runs, separated by single spaces with no newlines, so
+// every block is something the word RLE codec in doni.cpp can round-trip.
+static void runsStep(Rng& rng, uint64_t& counter, string& out) {
+    const char* word = WORDS[rng.skewed(WORD_COUNT)];
+    size_t run = 1 + rng.skewed(64);
+    for (size_t i = 0; i < run; i++) {
+        if (counter++ > 0) out += ' ';
+        out += word;
+    }
+}
+
+struct Profile {
+    const char* name;
+    ProfileStep step;
+    const char* description;
+};
+
+static const Profile PROFILES[] = {
+    { "logs", logsStep, "repetitive server access logs" },
+    { "text", textStep, "natural-language-like English text" },
+    { "json", jsonStep, "JSON telemetry records" },
+    { "random", randomStep, "incompressible random bytes" },
+    { "runs", runsStep, "long word runs for the RLE codec" },
+    { "longrepeat", nullptr, "text with segments repeated megabytes apart" },
+};
+
+static bool writeChunk(ofstream& file, string& chunk, uint64_t& remaining) {
+    size_t n = static_cast<size_t>(min<uint64_t>(chunk.size(), remaining));
+    file.write(chunk.data(), static_cast<streamsize>(n));
+    remaining -= n;
+    chunk.clear();
+    return static_cast<bool>(file);
+}
+
+// Fresh text interleaved with replays of a fixed library of segments. The
+// library is a few MB, but replays land at random points over the whole
+// file, so repeat distances grow with the file size and exceed any window.
+static bool generateLongRepeat(ofstream& file, uint64_t size, Rng& rng) {
+    const size_t SEGMENTS = 16;
+    size_t segment_size = static_cast<size_t>(min<uint64_t>(256 * 1024, max<uint64_t>(size / 64, 1024)));
+
+    vector<string> library(SEGMENTS);
+    uint64_t counter = 0;
+    for (auto& segment : library) {
+        while (segment.size() < segment_size) textStep(rng, counter, segment);
+        segment.resize(segment_size);
+    }
+
+    uint64_t remaining = size;
+    string chunk;
+    while (remaining > 0) {
+        if (rng.below(4) == 0) {
+            chunk += library[rng.below(SEGMENTS)];
+        }
+        else {
+            while (chunk.size() < segment_size) textStep(rng, counter, chunk);
+        }
+        if (!writeChunk(file, chunk, remaining)) return false;
+    }
+    return true;
+}
+
+static bool generate(const Profile& profile, uint64_t size, uint64_t seed, const string& filename) {
+    ofstream file(filename, ios::binary);
+    if (!file) {
+        cerr << "Cannot create " << filename << endl;
+        return false;
+    }
+    // Each profile gets its own stream, so adding a profile does not shift the others.
+    uint64_t profile_seed = seed;
+    for (const char* p = profile.name; *p; p++) profile_seed = profile_seed * 31 + static_cast<unsigned char>(*p);
+    Rng rng(profile_seed);
+
+    if (!profile.step) {
+        return generateLongRepeat(file, size, rng);
+    }
+
+    uint64_t remaining = size;
+    uint64_t counter = 0;
+    string chunk;
+    while (remaining > 0) {
+        while (chunk.size() < CHUNK_SIZE && chunk.size() < remaining) profile.step(rng, counter, chunk);
+        // A trailing separator would not survive the RLE codec's word split.
+        if (profile.step == runsStep && chunk.size() >= remaining && chunk[remaining - 1] == ' ') {
+            chunk[remaining - 1] = 'x';
+        }
+        if (!writeChunk(file, chunk, remaining)) return false;
+    }
+    return true;
+}
+
+static uint64_t parseSize(const string& text) {
+    char* end = nullptr;
+    uint64_t value = strtoull(text.c_str(), &end, 10);
+    if (end && (*end == 'k' || *end == 'K')) value <<= 10;
+    else if (end && (*end == 'm' || *end == 'M')) value <<= 20;
+    else if (end && (*end == 'g' || *end == 'G')) value <<= 30;
+    return value;
+}
+
+static void printUsage() {
+    cerr << "Usage:" << endl;
+    cerr << "  sjatie_corpus -p profile -s size [-S seed] -o file" << endl;
+    cerr << "  sjatie_corpus -a dir -s size [-S seed]" << endl;
+    cerr << "Size accepts K/M/G suffixes. Profiles:" << endl;
+    for (const auto& profile : PROFILES) {
+        cerr << "  " << profile.name << string(12 - string(profile.name).size(), ' ') << profile.description << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string profile_name, output, all_dir;
+    uint64_t size = 0;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-p" && has_value) profile_name = argv[++i];
+        else if (arg == "-s" && has_value) size = parseSize(argv[++i]);
+        else if (arg == "-S" && has_value) seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-o" && has_value) output = argv[++i];
+        else if (arg == "-a" && has_value) all_dir = argv[++i];
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (size == 0 || (all_dir.empty() && (profile_name.empty() || output.empty()))) {
+        printUsage();
+        return 2;
+    }
+
+    for (const auto& profile : PROFILES) {
+        if (!all_dir.empty()) {
+            if (!generate(profile, size, seed, all_dir + "/" + profile.name + ".dat")) return 1;
+        }
+        else if (profile_name == profile.name) {
+            return generate(profile, size, seed, output) ? 0 : 1;
+        }
+    }
+    if (all_dir.empty()) {
+        cerr << "Unknown profile: " << profile_name << endl;
+        printUsage();
+        return 2;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "CompressionAlgorithms.h"
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SJATIE_CRC32_HW 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// CRC32C (Castagnoli, reflected polynomial 0x82F63B78). Uses the SSE4.2
+// crc32 instruction when the CPU has it, slicing-by-8 tables otherwise.
+
+static const uint32_t CRC32C_POLY = 0x82F63B78u;
+
+struct Crc32cTables {
+    uint32_t t[8][256];
+
+    Crc32cTables() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int k = 0; k < 8; k++) {
+                crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+            }
+            t[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int k = 1; k < 8; k++) {
+                t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+static uint32_t crc32cSoftware(uint32_t crc, const unsigned char* p, size_t len) {
+    static const Crc32cTables tables;
+    const uint32_t (*t)[256] = tables.t;
+
+    while (len >= 8) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, p, 4);
+        std::memcpy(&hi, p + 4, 4);
+        // Tables are laid out for little-endian loads.
+        lo ^= crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+            t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef SJATIE_CRC32_HW
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse4.2")))
+#endif
+static uint32_t crc32cHardware(uint32_t crc, const unsigned char* p, size_t len) {
+    uint64_t crc64 = crc;
+    while (len >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        len -= 8;
+    }
+    uint32_t crc32 = static_cast<uint32_t>(crc64);
+    while (len--) {
+        crc32 = _mm_crc32_u8(crc32, *p++);
+    }
+    return crc32;
+}
+
+static bool cpuHasSse42() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+uint32_t crc32c_update(uint32_t crc, const char* data, size_t len) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    crc = ~crc;
+#ifdef SJATIE_CRC32_HW
+    static const bool hardware = cpuHasSse42();
+    if (hardware) {
+        return ~crc32cHardware(crc, p, len);
+    }
+#endif
+    return ~crc32cSoftware(crc, p, len);
+}
+
+uint32_t crc32c(const std::string& data) {
+    return crc32c_update(0, data.data(), data.size());
+}
\ No newline at end of file
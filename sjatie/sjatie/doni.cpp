@@ -1,4 +1,6 @@
 #include "CompressionAlgorithms.h"
+#include "CodecStats.h"
+#include "Kernels.h"
 #include <iostream>
 #include <chrono>
 #include <sstream>
@@ -54,13 +56,11 @@ std::string doni_decompress(const std::string& compressed) {
     return result;
 }
 
-CompressionResult doni_compress(const std::string& input) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-
+std::string doni_encode(const std::string& input) {
     std::string compressed_data;
 
     if (input.empty()) {
-        compressed_data = "";
+        return "";
     }
     else {
         auto words = splitIntoWords(input);
@@ -69,12 +69,14 @@ CompressionResult doni_compress(const std::string& input) {
             std::string current_word = words[0];
             int count = 1;
             std::stringstream ss;
+            STATS_ONLY(LocalHistogram run_lengths;)
 
             for (size_t i = 1; i < words.size(); i++) {
                 if (words[i] == current_word) {
                     count++;
                 }
                 else {
+                    STATS_ONLY(run_lengths.add(count);)
                     if (count > 1) {
                         ss << count << "|" << current_word << " ";
                     }
@@ -85,6 +87,8 @@ CompressionResult doni_compress(const std::string& input) {
                     count = 1;
                 }
             }
+            STATS_ONLY(run_lengths.add(count);)
+            STATS_MERGE(rle_run_length, run_lengths);
             if (count > 1) {
                 ss << count << "|" << current_word;
             }
@@ -98,11 +102,20 @@ CompressionResult doni_compress(const std::string& input) {
         }
     }
 
+    return compressed_data;
+}
+
+CompressionResult doni_compress(const std::string& input) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::string compressed_data = checksum_encode(CODEC_RLE, input);
+
     auto end_time = std::chrono::high_resolution_clock::now();
     auto compression_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
 
     auto decomp_start = std::chrono::high_resolution_clock::now();
-    std::string decompressed = doni_decompress(compressed_data);
+    bool checksum_ok = false;
+    std::string decompressed = checksum_decode(compressed_data, &checksum_ok);
     auto decomp_end = std::chrono::high_resolution_clock::now();
     auto decompression_time = std::chrono::duration_cast<std::chrono::microseconds>(decomp_end - decomp_start);
 
@@ -113,7 +126,7 @@ CompressionResult doni_compress(const std::string& input) {
     result.compression_ratio = compressed_data.empty() ? 1.0 : static_cast<double>(input.size()) / compressed_data.size();
     result.compression_time_ms = static_cast<double>(compression_time.count()) / 1000.0;
     result.decompression_time_ms = static_cast<double>(decompression_time.count()) / 1000.0;
-    result.integrity_ok = (input == decompressed);
+    result.integrity_ok = checksum_ok;
 
     return result;
 }
\ No newline at end of file
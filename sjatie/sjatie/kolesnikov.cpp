@@ -1,4 +1,6 @@
 #include "CompressionAlgorithms.h"
+#include "CodecStats.h"
+#include "Kernels.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -7,6 +9,8 @@
 #include <sstream>
 #include <chrono>
 #include <bitset>
+#include <cmath>
+#include <climits>
 
 struct HuffmanNode {
     char data;
@@ -49,8 +53,8 @@ HuffmanNode* buildHuffmanTree(const std::map<char, int>& freq) {
 
 void generateHuffmanCodes(HuffmanNode* root, std::string str, std::map<char, std::string>& huffmanCode) {
     if (!root) return;
-    if (root->data != '$') {
-        huffmanCode[root->data] = str;
+    if (!root->left && !root->right) {
+        huffmanCode[root->data] = str.empty() ? "0" : str;
     }
     generateHuffmanCodes(root->left, str + "0", huffmanCode);
     generateHuffmanCodes(root->right, str + "1", huffmanCode);
@@ -74,7 +78,13 @@ std::string bytesToBits(const std::string& bytes, size_t originalBitLength) {
     return bits.substr(0, originalBitLength);
 }
 
-std::string kolesnikov_decompress(const std::string& compressed) {
+// Bits the encoder emits for the tree's frequencies; a lone leaf still costs one bit per symbol.
+static uint64_t encodedBitLength(const HuffmanNode* node, uint64_t depth) {
+    if (!node->left && !node->right) return static_cast<uint64_t>(node->freq) * (depth ? depth : 1);
+    return encodedBitLength(node->left, depth + 1) + encodedBitLength(node->right, depth + 1);
+}
+
+std::string kolesnikov_decompress(const std::string& compressed, size_t max_symbols) {
     if (compressed.empty()) {
         return "";
     }
@@ -82,9 +92,12 @@ std::string kolesnikov_decompress(const std::string& compressed) {
     size_t pos = 0;
 
     if (pos >= compressed.size()) return "";
-    unsigned char freq_count = static_cast<unsigned char>(compressed[pos++]);
+    // A count byte of 0 means all 256 symbols are present.
+    int freq_count = static_cast<unsigned char>(compressed[pos++]);
+    if (freq_count == 0) freq_count = 256;
 
     std::map<char, int> freq;
+    uint64_t total = 0;
     for (int i = 0; i < freq_count; ++i) {
         if (pos + 4 > compressed.size()) return "";
         char ch = compressed[pos++];
@@ -93,8 +106,12 @@ std::string kolesnikov_decompress(const std::string& compressed) {
             (static_cast<unsigned char>(compressed[pos + 2]) << 8) |
             static_cast<unsigned char>(compressed[pos + 3]);
         pos += 4;
-        freq[ch] = freq_val;
+        // Node frequencies are ints and the encoder never writes a symbol twice or with count 0.
+        if (freq_val == 0 || freq_val > INT_MAX || freq.count(ch)) return "";
+        total += freq_val;
+        freq[ch] = static_cast<int>(freq_val);
     }
+    if (total > INT_MAX || total > max_symbols) return "";
 
     if (pos + 4 > compressed.size()) return "";
     uint32_t bit_length = (static_cast<unsigned char>(compressed[pos]) << 24) |
@@ -103,10 +120,22 @@ std::string kolesnikov_decompress(const std::string& compressed) {
         static_cast<unsigned char>(compressed[pos + 3]);
     pos += 4;
 
+    // The header must describe exactly the bits that follow it.
+    if ((static_cast<uint64_t>(bit_length) + 7) / 8 != compressed.size() - pos) return "";
+
     HuffmanNode* root = buildHuffmanTree(freq);
     if (!root) {
         return "";
     }
+    if (encodedBitLength(root, 0) != bit_length) {
+        delete root;
+        return "";
+    }
+    if (!root->left && !root->right) {
+        std::string single(root->freq, root->data);
+        delete root;
+        return single;
+    }
 
     std::string encoded_data = compressed.substr(pos);
     std::string bits = bytesToBits(encoded_data, bit_length);
@@ -131,19 +160,9 @@ std::string kolesnikov_decompress(const std::string& compressed) {
     return decoded_string;
 }
 
-CompressionResult kolesnikov_compress(const std::string& input) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-
+std::string kolesnikov_encode(const std::string& input) {
     if (input.empty()) {
-        CompressionResult result;
-        result.algorithm_name = "Huffman (Kolesnikov)";
-        result.original_size = 0;
-        result.compressed_size = 0;
-        result.compression_ratio = 1.0;
-        result.compression_time_ms = 0;
-        result.decompression_time_ms = 0;
-        result.integrity_ok = true;
-        return result;
+        return "";
     }
 
     std::map<char, int> freq;
@@ -153,25 +172,29 @@ CompressionResult kolesnikov_compress(const std::string& input) {
 
     HuffmanNode* root = buildHuffmanTree(freq);
     if (!root) {
-        CompressionResult result;
-        result.algorithm_name = "Huffman (Kolesnikov)";
-        result.original_size = input.size();
-        result.compressed_size = 0;
-        result.compression_ratio = 0.0;
-        result.compression_time_ms = 0;
-        result.decompression_time_ms = 0;
-        result.integrity_ok = false;
-        return result;
+        return "";
     }
 
     std::map<char, std::string> huffmanCode;
     generateHuffmanCodes(root, "", huffmanCode);
+    delete root;
 
     std::string encoded_bits;
     for (char c : input) {
         encoded_bits += huffmanCode[c];
     }
 
+    STATS_ONLY(
+        double entropy = 0.0;
+        for (const auto& p : freq) {
+            double share = static_cast<double>(p.second) / input.size();
+            entropy -= share * std::log2(share);
+        }
+    )
+    STATS_ADD(huffman_symbols, input.size());
+    STATS_ADD(huffman_code_bits, encoded_bits.size());
+    STATS_ADD(huffman_entropy_millibits, entropy * input.size() * 1000.0);
+
     std::ostringstream header;
     header << static_cast<char>(freq.size());
 
@@ -190,20 +213,35 @@ CompressionResult kolesnikov_compress(const std::string& input) {
     header << static_cast<char>((bit_length >> 8) & 0xFF);
     header << static_cast<char>(bit_length & 0xFF);
 
-    std::string header_str = header.str();
-    std::string compressed_bits = bitsToBytes(encoded_bits);
-    std::string compressed_data = header_str + compressed_bits;
+    return header.str() + bitsToBytes(encoded_bits);
+}
+
+CompressionResult kolesnikov_compress(const std::string& input) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    if (input.empty()) {
+        CompressionResult result;
+        result.algorithm_name = "Huffman (Kolesnikov)";
+        result.original_size = 0;
+        result.compressed_size = 0;
+        result.compression_ratio = 1.0;
+        result.compression_time_ms = 0;
+        result.decompression_time_ms = 0;
+        result.integrity_ok = true;
+        return result;
+    }
+
+    std::string compressed_data = checksum_encode(CODEC_HUFFMAN, input);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto compression_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
 
     auto decomp_start = std::chrono::high_resolution_clock::now();
-    std::string decompressed = kolesnikov_decompress(compressed_data);
+    bool checksum_ok = false;
+    std::string decompressed = checksum_decode(compressed_data, &checksum_ok);
     auto decomp_end = std::chrono::high_resolution_clock::now();
     auto decompression_time = std::chrono::duration_cast<std::chrono::microseconds>(decomp_end - decomp_start);
 
-    delete root;
-
     CompressionResult result;
     result.algorithm_name = "Huffman (Kolesnikov)";
     result.original_size = input.size();
@@ -211,7 +249,7 @@ CompressionResult kolesnikov_compress(const std::string& input) {
     result.compression_ratio = (input.size() > 0) ? static_cast<double>(input.size()) / compressed_data.size() : 1.0;
     result.compression_time_ms = static_cast<double>(compression_time.count()) / 1000.0;
     result.decompression_time_ms = static_cast<double>(decompression_time.count()) / 1000.0;
-    result.integrity_ok = (input == decompressed);
+    result.integrity_ok = checksum_ok;
 
     return result;
 }
\ No newline at end of file
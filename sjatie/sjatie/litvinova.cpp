@@ -1,4 +1,6 @@
 #include "CompressionAlgorithms.h"
+#include "CodecStats.h"
+#include "Kernels.h"
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -64,9 +66,7 @@ vector<int> binaryStringToCodes(const string& binary_str, int initialCodeSize) {
     return codes;
 }
 
-string lzw_compress_binary(const string& s) {
-    if (s.empty()) return "";
-
+vector<int> lzw_build_codes(const string& s) {
     unordered_map<string, int> dict;
     int dict_size = 256; 
 
@@ -95,7 +95,17 @@ string lzw_compress_binary(const string& s) {
         compressed.push_back(dict[w]);
     }
 
-    return codesToBinaryString(compressed, 8);
+    STATS_ADD(lzw_calls, 1);
+    STATS_ADD(lzw_codes, compressed.size());
+    STATS_ADD(lzw_dict_entries, dict_size);
+    STATS_ADD(lzw_dict_full_events, dict_size >= 65536 ? 1 : 0);
+
+    return compressed;
+}
+
+string lzw_compress_binary(const string& s) {
+    if (s.empty()) return "";
+    return codesToBinaryString(lzw_build_codes(s), 8);
 }
 
 string lzw_decompress_binary(const string& compressed) {
@@ -144,6 +154,10 @@ string lzw_decompress_binary(const string& compressed) {
     return result;
 }
 
+string litvinova_encode(const string& input) {
+    return lzw_compress_binary(input);
+}
+
 string litvinova_decompress(const string& compressed) {
     if (compressed.empty()) {
         return "";
@@ -153,12 +167,13 @@ string litvinova_decompress(const string& compressed) {
 
 CompressionResult litvinova_compress(const string& input) {
     auto start = chrono::high_resolution_clock::now();
-    string compressed = lzw_compress_binary(input);
+    string compressed = checksum_encode(CODEC_LZW, input);
     auto end = chrono::high_resolution_clock::now();
     auto comp_time = chrono::duration_cast<chrono::milliseconds>(end - start);
 
     auto decomp_start = chrono::high_resolution_clock::now();
-    string decompressed = litvinova_decompress(compressed);
+    bool checksum_ok = false;
+    string decompressed = checksum_decode(compressed, &checksum_ok);
     auto decomp_end = chrono::high_resolution_clock::now();
     auto decomp_time = chrono::duration_cast<chrono::milliseconds>(decomp_end - decomp_start);
 
@@ -169,7 +184,7 @@ CompressionResult litvinova_compress(const string& input) {
     r.compression_ratio = compressed.empty() ? 1.0 : static_cast<double>(input.size()) / compressed.size();
     r.compression_time_ms = static_cast<double>(comp_time.count());
     r.decompression_time_ms = static_cast<double>(decomp_time.count());
-    r.integrity_ok = (input == decompressed);
+    r.integrity_ok = checksum_ok;
 
     return r;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "CompressionAlgorithms.h"
+#include "Kernels.h"
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Per-kernel microbenchmarks over a corpus (data1.txt..data6.txt by default).
+// Each kernel is repeated until it has run for at least MIN_SECONDS and
+// reported as MB/s of corpus input it covered.
+//
+//   sjatie_bench [-k kernel] [file...]
+
+static const double MIN_SECONDS = 0.2;
+// LZ77 matching and LZW are far slower than the rest, so they see a prefix only.
+static const size_t SLOW_KERNEL_BYTES = 64 * 1024;
+
+struct Kernel {
+    string name;
+    size_t input_bytes;
+    function<void()> run;
+};
+
+static string readCorpusFile(const string& filename) {
+    ifstream file(filename, ios::binary);
+    return string((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+}
+
+// Keeps results alive so the optimizer cannot drop a kernel call.
+static volatile size_t sink;
+
+int main(int argc, char* argv[]) {
+    string only;
+    vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-k" && i + 1 < argc) {
+            only = argv[++i];
+        }
+        else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        for (int i = 1; i <= 6; i++) files.push_back("data" + to_string(i) + ".txt");
+    }
+
+    string corpus;
+    for (const auto& file : files) corpus += readCorpusFile(file);
+    if (corpus.empty()) {
+        cerr << "Empty corpus, pass files or run from the directory with data1.txt..data6.txt" << endl;
+        return 1;
+    }
+
+    const string slow = corpus.substr(0, SLOW_KERNEL_BYTES);
+    const vector<int> lzw_codes = lzw_build_codes(slow);
+    const string lzw_packed = codesToBinaryString(lzw_codes, 8);
+    const string huffman_packed = kolesnikov_encode(corpus);
+    string huffman_bits;
+    for (unsigned char c : corpus) huffman_bits += static_cast<char>('0' + (c & 1));
+
+    vector<Kernel> kernels = {
+        { "lz77_match_finding", slow.size(), [&]() {
+            size_t i = 0;
+            while (i < slow.size()) {
+                LZ77Triple match = findLongestMatch(slow, i, 4096, 255);
+                i += match.length + 1;
+                sink = i;
+            }
+        } },
+        { "lzw_dictionary_step", slow.size(), [&]() { sink = lzw_build_codes(slow).size(); } },
+        { "lzw_bit_packing", slow.size(), [&]() { sink = codesToBinaryString(lzw_codes, 8).size(); } },
+        { "lzw_bit_unpacking", slow.size(), [&]() { sink = binaryStringToCodes(lzw_packed, 8).size(); } },
+        { "huffman_bit_packing", corpus.size(), [&]() { sink = bitsToBytes(huffman_bits).size(); } },
+        { "huffman_decode", corpus.size(), [&]() { sink = kolesnikov_decompress(huffman_packed).size(); } },
+        { "rle_tokenize", corpus.size(), [&]() { sink = splitIntoWords(corpus).size(); } },
+    };
+
+    cout << "Corpus: " << corpus.size() << " bytes from " << files.size() << " file(s)" << endl;
+    cout << left << setw(25) << "Kernel";
+    cout << right << setw(12) << "Input";
+    cout << right << setw(8) << "Iters";
+    cout << right << setw(14) << "ms/iter";
+    cout << right << setw(12) << "MB/s";
+    cout << endl;
+    cout << string(71, '-') << endl;
+
+    for (const auto& kernel : kernels) {
+        if (!only.empty() && kernel.name != only) continue;
+
+        kernel.run();
+        size_t iterations = 0;
+        auto start = chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            kernel.run();
+            iterations++;
+            elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        } while (elapsed < MIN_SECONDS);
+
+        double per_iter = elapsed / iterations;
+        cout << left << setw(25) << kernel.name;
+        cout << right << setw(12) << kernel.input_bytes;
+        cout << right << setw(8) << iterations;
+        cout << right << setw(14) << fixed << setprecision(3) << per_iter * 1000.0;
+        cout << right << setw(12) << fixed << setprecision(2) << kernel.input_bytes / per_iter / 1e6;
+        cout << endl;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "CompressionAlgorithms.h"
+#include "CodecStats.h"
+#include "Kernels.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -9,15 +11,6 @@
 
 using namespace std;
 
-struct LZ77Triple {
-    unsigned short offset;
-    unsigned char length;
-    char next_char;
-
-    LZ77Triple(unsigned short o = 0, unsigned char l = 0, char c = 0) : offset(o), length(l), next_char(c) {}
-};
-
-
 string packTriple(const LZ77Triple& triple) {
     string packed = "";
     packed += static_cast<char>((triple.offset >> 8) & 0xFF);
@@ -41,15 +34,18 @@ LZ77Triple unpackTriple(const string& data, size_t& pos) {
     return LZ77Triple(offset, length, next_char);
 }
 
+// Candidates scanned per position; caps the window below search_buffer_size.
+static const size_t LIMITED_SEARCH_SIZE = 2048;
+
 LZ77Triple findLongestMatch(const string& input, size_t current_pos, size_t search_buffer_size, size_t look_ahead_buffer_size) {
     size_t start_search = (current_pos > search_buffer_size) ? current_pos - search_buffer_size : 0;
     size_t end_search = current_pos;
-    size_t end_look_ahead = min(current_pos + look_ahead_buffer_size, input.length());
+    // Stop one byte short of the input end so every triple carries a real next_char.
+    size_t end_look_ahead = min(current_pos + look_ahead_buffer_size, input.length() - 1);
 
     size_t best_offset = 0;
     size_t best_length = 0;
 
-    const size_t LIMITED_SEARCH_SIZE = 2048;
     size_t limited_start = (current_pos > LIMITED_SEARCH_SIZE) ? current_pos - LIMITED_SEARCH_SIZE : 0;
     start_search = max(start_search, limited_start);
 
@@ -68,13 +64,11 @@ LZ77Triple findLongestMatch(const string& input, size_t current_pos, size_t sear
         }
     }
 
-    char next_char = (current_pos + best_length < input.length()) ? input[current_pos + best_length] : 0;
+    char next_char = input[current_pos + best_length];
     return LZ77Triple(static_cast<unsigned short>(best_offset), static_cast<unsigned char>(best_length), next_char);
 }
 
-CompressionResult milyaeva_compress(const string& input) {
-    auto start_time = chrono::high_resolution_clock::now();
-
+string milyaeva_encode(const string& input) {
     string compressed_data = "";
 
     if (input.empty()) {
@@ -85,9 +79,11 @@ CompressionResult milyaeva_compress(const string& input) {
         size_t i = 0;
         const size_t SEARCH_BUFFER_SIZE = 4096;
         const size_t LOOK_AHEAD_BUFFER_SIZE = 255;
+        STATS_ONLY(LocalHistogram match_lengths; LocalHistogram match_offsets; uint64_t chain_steps = 0;)
 
         while (i < input.length()) {
             LZ77Triple match = findLongestMatch(input, i, SEARCH_BUFFER_SIZE, LOOK_AHEAD_BUFFER_SIZE);
+            STATS_ONLY(chain_steps += min(i, min(SEARCH_BUFFER_SIZE, LIMITED_SEARCH_SIZE));)
 
             if (match.length == 0) {
                 triples.push_back(LZ77Triple(0, 0, input[i]));
@@ -95,9 +91,14 @@ CompressionResult milyaeva_compress(const string& input) {
             }
             else {
                 triples.push_back(match);
+                STATS_ONLY(match_lengths.add(match.length); match_offsets.add(match.offset);)
                 i += match.length + 1;
             }
         }
+        STATS_ADD(lz77_searches, triples.size());
+        STATS_ADD(lz77_chain_steps, chain_steps);
+        STATS_MERGE(lz77_match_length, match_lengths);
+        STATS_MERGE(lz77_match_offset, match_offsets);
 
         stringstream ss;
         ss << triples.size() << "|";
@@ -107,11 +108,20 @@ CompressionResult milyaeva_compress(const string& input) {
         compressed_data = ss.str();
     }
 
+    return compressed_data;
+}
+
+CompressionResult milyaeva_compress(const string& input) {
+    auto start_time = chrono::high_resolution_clock::now();
+
+    string compressed_data = checksum_encode(CODEC_LZ77, input);
+
     auto end_time = chrono::high_resolution_clock::now();
     auto compression_time = chrono::duration_cast<chrono::microseconds>(end_time - start_time);
 
     auto decomp_start = chrono::high_resolution_clock::now();
-    string decompressed = milyaeva_decompress(compressed_data);
+    bool checksum_ok = false;
+    string decompressed = checksum_decode(compressed_data, &checksum_ok);
     auto decomp_end = chrono::high_resolution_clock::now();
     auto decompression_time = chrono::duration_cast<chrono::microseconds>(decomp_end - decomp_start);
 
@@ -123,7 +133,7 @@ CompressionResult milyaeva_compress(const string& input) {
     result.compression_time_ms = static_cast<double>(compression_time.count());
     result.compression_time_ms = static_cast<double>(compression_time.count()) / 1000.0;
     result.decompression_time_ms = static_cast<double>(decompression_time.count()) / 1000.0;
-    result.integrity_ok = (input == decompressed);
+    result.integrity_ok = checksum_ok;
 
     return result;
 }
@@ -155,6 +165,7 @@ string milyaeva_decompress(const string& compressed) {
             result += triple.next_char;
         }
         else if (triple.offset > 0 && triple.length > 0) {
+            if (triple.offset > result.length()) return "";
             size_t start = result.length() - triple.offset;
             if (start + triple.length <= result.length()) {
                 result.append(result.substr(start, triple.length));
@@ -162,9 +173,7 @@ string milyaeva_decompress(const string& compressed) {
             else {
                 return "";
             }
-            if (triple.next_char != 0) {
-                result += triple.next_char;
-            }
+            result += triple.next_char;
         }
         else {
             return "";
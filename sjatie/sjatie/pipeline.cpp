@@ -0,0 +1,270 @@
+#include "CompressionAlgorithms.h"
+#include "ByteIO.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Three-stage streaming pipeline: the calling thread reads blocks, a pool of
+// workers runs the codec, and a writer thread emits results in input order.
+// Both queues are bounded, so at most a few blocks per worker are in memory
+// and reading/writing overlaps with codec time.
+//
+// Stream layout: PIPE_MAGIC followed by auto container block records (see
+// encode_block_record), so a stream is also a valid auto_decompress input
+// once the magic is stripped. With a filter chain the header is
+// PIPE_FILTERED_MAGIC, a filter count byte and the filter ids, and each
+// block is
+//
+//   [flags][crc32c u32 of the unfiltered block, if BLOCK_RAW_CRC][record without checksum]
+//
+// where BLOCK_FILTERED says whether the chain was applied to this block.
+
+static const char PIPE_MAGIC[4] = { 'S', 'J', 'P', '1' };
+static const char PIPE_FILTERED_MAGIC[4] = { 'S', 'J', 'P', '2' };
+static const unsigned char BLOCK_FILTERED = 0x01;
+static const unsigned char BLOCK_RAW_CRC = 0x80;
+
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity), closed_(false) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]() { return items_.size() < capacity_; });
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+    }
+
+    // Returns false once the queue is closed and drained.
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this]() { return !items_.empty() || closed_; });
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    bool closed_;
+    std::deque<T> items_;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+typedef std::function<std::string()> BlockJob;
+
+// Runs jobs produced by nextJob on the worker pool and writes their results
+// to out in order. nextJob returns false when there is nothing more to run.
+static bool runPipeline(const std::function<bool(BlockJob&)>& nextJob, std::ostream& out, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Triple buffering per worker: one block being coded, one queued, one being written.
+    BoundedQueue<std::packaged_task<std::string()>> work(threads);
+    BoundedQueue<std::future<std::string>> ordered(threads * 2);
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&work]() {
+            std::packaged_task<std::string()> task;
+            while (work.pop(task)) {
+                task();
+            }
+        });
+    }
+
+    bool write_ok = true;
+    std::thread writer([&]() {
+        std::future<std::string> result;
+        while (ordered.pop(result)) {
+            std::string data;
+            try {
+                data = result.get();
+            }
+            catch (...) {
+                // A job that threw (e.g. out of memory) fails the stream instead of terminating.
+                write_ok = false;
+            }
+            if (write_ok) {
+                out.write(data.data(), static_cast<std::streamsize>(data.size()));
+                write_ok = static_cast<bool>(out);
+            }
+        }
+    });
+
+    BlockJob job;
+    while (nextJob(job)) {
+        std::packaged_task<std::string()> task(job);
+        ordered.push(task.get_future());
+        work.push(std::move(task));
+    }
+
+    work.close();
+    for (auto& worker : workers) worker.join();
+    ordered.close();
+    writer.join();
+    out.flush();
+
+    return write_ok && static_cast<bool>(out);
+}
+
+static std::string readExactly(std::istream& in, size_t n) {
+    std::string buffer(n, '\0');
+    in.read(&buffer[0], static_cast<std::streamsize>(n));
+    buffer.resize(static_cast<size_t>(in.gcount()));
+    return buffer;
+}
+
+// Keeps the filter chain only when it pays off: the filtered block must not
+// grow and must still code below stored size. Incompressible blocks are
+// stored unfiltered, without the filters' headers and escapes.
+static std::string encodeFilteredBlock(const std::string& block, const PipelineOptions& options) {
+    std::string filtered = filter_chain_apply(options.filters, block);
+    unsigned char flags = options.with_checksum ? BLOCK_RAW_CRC : 0;
+    std::string record;
+    if (filtered.size() > block.size()) {
+        record = encode_block_record(block, options.codec, options.min_throughput_mb_s, false);
+    }
+    else {
+        std::string payload;
+        CodecId id = encode_block_payload(filtered, options.codec, options.min_throughput_mb_s, payload);
+        if (id != CODEC_STORED) {
+            flags |= BLOCK_FILTERED;
+            record = make_block_record(id, filtered.size(), payload, false, 0);
+        }
+        else {
+            record = make_block_record(CODEC_STORED, block.size(), block, false, 0);
+        }
+    }
+
+    std::string out(1, static_cast<char>(flags));
+    if (options.with_checksum) {
+        putU32(out, crc32c(block));
+    }
+    return out + record;
+}
+
+bool pipeline_compress(std::istream& in, std::ostream& out, const PipelineOptions& options) {
+    if (options.filters.size() > MAX_FILTER_CHAIN) return false;
+    if (options.filters.empty()) {
+        out.write(PIPE_MAGIC, 4);
+    }
+    else {
+        std::string header(PIPE_FILTERED_MAGIC, 4);
+        header += static_cast<char>(options.filters.size());
+        for (FilterId filter : options.filters) header += static_cast<char>(filter);
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+    size_t block_size = options.block_size ? options.block_size : (1 << 20);
+
+    auto nextJob = [&](BlockJob& job) {
+        std::string block = readExactly(in, block_size);
+        if (block.empty()) return false;
+        job = [block = std::move(block), options]() {
+            if (!options.filters.empty()) {
+                return encodeFilteredBlock(block, options);
+            }
+            return encode_block_record(block, options.codec, options.min_throughput_mb_s, options.with_checksum);
+        };
+        return true;
+    };
+    return runPipeline(nextJob, out, options.threads) && !in.bad();
+}
+
+bool pipeline_decompress(std::istream& in, std::ostream& out, unsigned threads) {
+    std::string magic = readExactly(in, 4);
+    if (magic.size() != 4) return false;
+    std::vector<FilterId> filters;
+    bool filtered_stream = magic.compare(0, 4, PIPE_FILTERED_MAGIC, 4) == 0;
+    if (filtered_stream) {
+        std::string count = readExactly(in, 1);
+        if (count.empty() || static_cast<unsigned char>(count[0]) > MAX_FILTER_CHAIN) return false;
+        std::string ids = readExactly(in, static_cast<unsigned char>(count[0]));
+        if (ids.size() != static_cast<unsigned char>(count[0])) return false;
+        for (char id : ids) {
+            if (id <= 0 || id >= FILTER_COUNT) return false;
+            filters.push_back(static_cast<FilterId>(id));
+        }
+    }
+    else if (magic.compare(0, 4, PIPE_MAGIC, 4) != 0) {
+        return false;
+    }
+
+    // A record that cannot be read or decoded marks the whole stream corrupt.
+    bool corrupt = false;
+    std::mutex corrupt_mutex;
+
+    auto markCorrupt = [&]() {
+        std::lock_guard<std::mutex> lock(corrupt_mutex);
+        corrupt = true;
+        return false;
+    };
+
+    auto nextJob = [&](BlockJob& job) {
+        unsigned char flags = 0;
+        uint32_t expected = 0;
+        if (filtered_stream) {
+            std::string prefix = readExactly(in, 1);
+            if (prefix.empty()) return false;
+            flags = static_cast<unsigned char>(prefix[0]);
+            if (flags & ~(BLOCK_FILTERED | BLOCK_RAW_CRC)) return markCorrupt();
+            if (flags & BLOCK_RAW_CRC) {
+                std::string crc = readExactly(in, 4);
+                if (crc.size() != 4) return markCorrupt();
+                expected = getU32(crc, 0);
+            }
+        }
+
+        std::string record = readExactly(in, BLOCK_RECORD_HEADER_SIZE);
+        if (record.empty() && !filtered_stream) return false;
+        size_t record_size = block_record_size(record);
+        if (record_size != 0) {
+            record += readExactly(in, record_size - record.size());
+        }
+        if (record_size == 0 || record.size() != record_size) return markCorrupt();
+
+        job = [record = std::move(record), flags, expected, &filters, &corrupt, &corrupt_mutex]() {
+            // Decoders may throw on malformed payloads; that is corruption too.
+            std::string block;
+            try {
+                block = auto_decompress(record);
+                if (flags & BLOCK_FILTERED) {
+                    block = filter_chain_revert(filters, block);
+                }
+                if ((flags & BLOCK_RAW_CRC) && crc32c(block) != expected) {
+                    block.clear();
+                }
+            }
+            catch (...) {
+                block.clear();
+            }
+            if (block.empty()) {
+                std::lock_guard<std::mutex> lock(corrupt_mutex);
+                corrupt = true;
+            }
+            return block;
+        };
+        return true;
+    };
+    bool ok = runPipeline(nextJob, out, threads);
+    std::lock_guard<std::mutex> lock(corrupt_mutex);
+    return ok && !corrupt;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "CompressionAlgorithms.h"
+#include "ByteIO.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Seekable archive: independently compressed blocks followed by an index
+// and a fixed-size trailer.
+//
+//   [block 0][block 1]...[index entry * block_count][block_count u32][index_offset u64]["SJSK"]
+//   index entry: [codec id][raw_offset u64][raw_len u32][comp_offset u64][comp_len u32][crc32c u32]
+//
+// read_range only fetches the trailer, the index and the blocks overlapping
+// the requested range.
+
+static const char SEEKABLE_MAGIC[4] = { 'S', 'J', 'S', 'K' };
+static const size_t SEEKABLE_TRAILER_SIZE = 16;
+static const size_t SEEKABLE_ENTRY_SIZE = 29;
+
+struct SeekableEntry {
+    CodecId codec;
+    uint64_t raw_offset;
+    uint32_t raw_len;
+    uint64_t comp_offset;
+    uint32_t comp_len;
+    uint32_t crc;
+};
+
+typedef std::function<std::string(uint64_t, size_t)> ReadAt;
+
+std::string seekable_encode(const std::string& input, CodecId codec, size_t block_size) {
+    if (block_size == 0) block_size = 65536;
+
+    std::string out;
+    std::vector<SeekableEntry> index;
+    for (size_t pos = 0; pos < input.size(); pos += block_size) {
+        std::string block = input.substr(pos, block_size);
+        SeekableEntry entry;
+        std::string payload;
+        entry.codec = encode_block_payload(block, codec, 0.0, payload);
+        entry.raw_offset = pos;
+        entry.raw_len = static_cast<uint32_t>(block.size());
+        entry.comp_offset = out.size();
+        entry.comp_len = static_cast<uint32_t>(payload.size());
+        entry.crc = crc32c(block);
+        index.push_back(entry);
+        out += payload;
+    }
+
+    uint64_t index_offset = out.size();
+    for (const auto& entry : index) {
+        out += static_cast<char>(entry.codec);
+        putU64(out, entry.raw_offset);
+        putU32(out, entry.raw_len);
+        putU64(out, entry.comp_offset);
+        putU32(out, entry.comp_len);
+        putU32(out, entry.crc);
+    }
+    putU32(out, static_cast<uint32_t>(index.size()));
+    putU64(out, index_offset);
+    out.append(SEEKABLE_MAGIC, 4);
+    return out;
+}
+
+static bool readIndex(const ReadAt& readAt, uint64_t archive_size, std::vector<SeekableEntry>& index) {
+    if (archive_size < SEEKABLE_TRAILER_SIZE) return false;
+    std::string trailer = readAt(archive_size - SEEKABLE_TRAILER_SIZE, SEEKABLE_TRAILER_SIZE);
+    if (trailer.size() != SEEKABLE_TRAILER_SIZE || trailer.compare(12, 4, SEEKABLE_MAGIC, 4) != 0) return false;
+
+    uint32_t block_count = getU32(trailer, 0);
+    uint64_t index_offset = getU64(trailer, 4);
+    uint64_t index_size = static_cast<uint64_t>(block_count) * SEEKABLE_ENTRY_SIZE;
+    if (index_size > archive_size - SEEKABLE_TRAILER_SIZE ||
+        index_offset != archive_size - SEEKABLE_TRAILER_SIZE - index_size) return false;
+
+    std::string raw = readAt(index_offset, static_cast<size_t>(index_size));
+    if (raw.size() != index_size) return false;
+
+    index.clear();
+    for (size_t pos = 0; pos < raw.size(); pos += SEEKABLE_ENTRY_SIZE) {
+        SeekableEntry entry;
+        unsigned char id = static_cast<unsigned char>(raw[pos]);
+        if (id >= CODEC_COUNT) return false;
+        entry.codec = static_cast<CodecId>(id);
+        entry.raw_offset = getU64(raw, pos + 1);
+        entry.raw_len = getU32(raw, pos + 9);
+        entry.comp_offset = getU64(raw, pos + 13);
+        entry.comp_len = getU32(raw, pos + 21);
+        entry.crc = getU32(raw, pos + 25);
+        if (entry.comp_offset > index_offset || entry.comp_len > index_offset - entry.comp_offset) return false;
+        // Blocks must tile the raw stream in order; readRange binary-searches on raw_offset.
+        uint64_t expected_offset = index.empty() ? 0 : index.back().raw_offset + index.back().raw_len;
+        if (entry.raw_offset != expected_offset) return false;
+        index.push_back(entry);
+    }
+    return true;
+}
+
+static std::string readRange(const ReadAt& readAt, uint64_t archive_size, uint64_t offset, size_t len) {
+    std::vector<SeekableEntry> index;
+    if (!readIndex(readAt, archive_size, index)) return "";
+
+    // First block whose raw range ends after offset.
+    auto it = std::upper_bound(index.begin(), index.end(), offset,
+        [](uint64_t value, const SeekableEntry& entry) {
+            return value < entry.raw_offset + entry.raw_len;
+        });
+
+    std::string result;
+    // "Read to the end" callers pass SIZE_MAX; keep offset + len from wrapping.
+    uint64_t end = offset + std::min<uint64_t>(len, UINT64_MAX - offset);
+    for (; it != index.end() && it->raw_offset < end; ++it) {
+        std::string block = codec_decode(it->codec, readAt(it->comp_offset, it->comp_len));
+        if (block.size() != it->raw_len || crc32c(block) != it->crc) return "";
+
+        uint64_t from = std::max(offset, it->raw_offset) - it->raw_offset;
+        uint64_t to = std::min(end, it->raw_offset + it->raw_len) - it->raw_offset;
+        result.append(block, static_cast<size_t>(from), static_cast<size_t>(to - from));
+    }
+    return result;
+}
+
+std::string seekable_read_range(const std::string& archive, uint64_t offset, size_t len) {
+    ReadAt readAt = [&archive](uint64_t pos, size_t n) {
+        if (pos >= archive.size()) return std::string();
+        return archive.substr(static_cast<size_t>(pos), n);
+    };
+    return readRange(readAt, archive.size(), offset, len);
+}
+
+std::string seekable_read_range_file(const std::string& filename, uint64_t offset, size_t len) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return "";
+    file.seekg(0, std::ios::end);
+    uint64_t archive_size = static_cast<uint64_t>(file.tellg());
+
+    ReadAt readAt = [&file](uint64_t pos, size_t n) {
+        std::string buffer(n, '\0');
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(pos));
+        file.read(&buffer[0], static_cast<std::streamsize>(n));
+        buffer.resize(static_cast<size_t>(file.gcount()));
+        return buffer;
+    };
+    return readRange(readAt, archive_size, offset, len);
+}
+
+uint64_t seekable_size(const std::string& archive) {
+    ReadAt readAt = [&archive](uint64_t pos, size_t n) {
+        return archive.substr(static_cast<size_t>(pos), n);
+    };
+    std::vector<SeekableEntry> index;
+    if (!readIndex(readAt, archive.size(), index) || index.empty()) return 0;
+    return index.back().raw_offset + index.back().raw_len;
+}
+
+std::string seekable_decompress(const std::string& archive) {
+    return seekable_read_range(archive, 0, static_cast<size_t>(seekable_size(archive)));
+}
+
+CompressionResult seekable_compress(const std::string& input, CodecId codec, size_t block_size) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::string compressed_data = seekable_encode(input, codec, block_size);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto compression_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    auto decomp_start = std::chrono::high_resolution_clock::now();
+    std::string decompressed = seekable_decompress(compressed_data);
+    auto decomp_end = std::chrono::high_resolution_clock::now();
+    auto decompression_time = std::chrono::duration_cast<std::chrono::microseconds>(decomp_end - decomp_start);
+
+    CompressionResult result;
+    result.algorithm_name = std::string("Seekable ") + codec_name(codec);
+    result.original_size = input.size();
+    result.compressed_size = compressed_data.size();
+    result.compression_ratio = compressed_data.empty() ? 1.0 : static_cast<double>(input.size()) / compressed_data.size();
+    result.compression_time_ms = static_cast<double>(compression_time.count()) / 1000.0;
+    result.decompression_time_ms = static_cast<double>(decompression_time.count()) / 1000.0;
+    // Every block is CRC-checked by read_range, which returns nothing on a mismatch.
+    // A range straddling the first block boundary also checks the random-access path.
+    if (block_size == 0) block_size = 65536;
+    uint64_t offset = std::min(input.size(), block_size / 2);
+    size_t len = std::min(input.size() - static_cast<size_t>(offset), block_size);
+    result.integrity_ok = decompressed.size() == input.size() &&
+        seekable_read_range(compressed_data, offset, len) == input.substr(static_cast<size_t>(offset), len);
+
+    return result;
+}
\ No newline at end of file
@@ -1,13 +1,24 @@
 ﻿#include <iostream>
+#include <algorithm>
 #include <string>
 #include <iomanip>
 #include <fstream>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
 #include "CompressionAlgorithms.h"
+#include "CodecStats.h"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 using namespace std;
 
 string readFile(const string& filename) {
-    ifstream file(filename);
+    ifstream file(filename, ios::binary);
     string content((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
     file.close();
     return content;
@@ -24,8 +35,173 @@ void printResult(const CompressionResult& result) {
     cout << endl;
 }
 
-int main() {
-    string filename = "data6.txt";
+void printUsage() {
+    cerr << "Usage:" << endl;
+    cerr << "  sjatie                          compare all codecs on data6.txt" << endl;
+    cerr << "  sjatie -r file...               compare all codecs on each file" << endl;
+    cerr << "  sjatie -c [options] [in] [out]  compress (default: stdin to stdout)" << endl;
+    cerr << "  sjatie -d [options] [in] [out]  decompress" << endl;
+    cerr << "Options:" << endl;
+    cerr << "  -m codec    auto, stored, huffman, lzw, lz77, rle, bwt (default auto)" << endl;
+    cerr << "  -l level    1-9, speed budget for auto: 1 fastest, 9 best ratio (default 5)" << endl;
+    cerr << "  -b size     block size, K/M suffix allowed (default 1M)" << endl;
+    cerr << "  -t threads  worker threads, 0 = all cores (default 0)" << endl;
+    cerr << "  -f filters  comma-separated chain run before the codec: columns, delta, e8e9" << endl;
+    cerr << "  -n          do not store block checksums" << endl;
+    cerr << "Use - for stdin/stdout." << endl;
+}
+
+bool parseCodec(const string& name, CodecId& codec) {
+    if (name == "auto") {
+        codec = CODEC_AUTO;
+        return true;
+    }
+    for (int id = 0; id < CODEC_COUNT; id++) {
+        string candidate = codec_name(static_cast<CodecId>(id));
+        for (auto& c : candidate) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        if (candidate == name) {
+            codec = static_cast<CodecId>(id);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t parseSize(const string& text) {
+    char* end = nullptr;
+    unsigned long long value = strtoull(text.c_str(), &end, 10);
+    if (end && (*end == 'k' || *end == 'K')) value <<= 10;
+    else if (end && (*end == 'm' || *end == 'M')) value <<= 20;
+    return static_cast<size_t>(value);
+}
+
+// Whole decimal number in [min, max]; atoi would take "abc" as 0 and "-1" as a huge unsigned.
+bool parseInt(const string& text, long min, long max, long& value) {
+    char* end = nullptr;
+    value = strtol(text.c_str(), &end, 10);
+    return !text.empty() && end && *end == '\0' && value >= min && value <= max;
+}
+
+// Minimum codec speed (MB/s) that auto mode may pick at each level.
+double levelBudget(int level) {
+    if (level <= 1) return 10.0;
+    if (level <= 5) return 4.0;
+    return 0.0;
+}
+
+int runCli(int argc, char* argv[]) {
+    bool decompress = false;
+    PipelineOptions options;
+    options.codec = CODEC_AUTO;
+    options.min_throughput_mb_s = levelBudget(5);
+    options.block_size = 1 << 20;
+    options.threads = 0;
+    options.with_checksum = true;
+    vector<string> files;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-c") {
+            decompress = false;
+        }
+        else if (arg == "-d") {
+            decompress = true;
+        }
+        else if (arg == "-n") {
+            options.with_checksum = false;
+        }
+        else if (arg == "-m" && has_value) {
+            if (!parseCodec(argv[++i], options.codec)) {
+                cerr << "Unknown codec: " << argv[i] << endl;
+                return 2;
+            }
+        }
+        else if (arg == "-l" && has_value) {
+            long level = 0;
+            if (!parseInt(argv[++i], 1, 9, level)) {
+                cerr << "Invalid level: " << argv[i] << endl;
+                return 2;
+            }
+            options.min_throughput_mb_s = levelBudget(static_cast<int>(level));
+        }
+        else if (arg == "-b" && has_value) {
+            options.block_size = parseSize(argv[++i]);
+            if (options.block_size == 0 || options.block_size > MAX_BLOCK_SIZE) {
+                cerr << "Invalid block size: " << argv[i] << endl;
+                return 2;
+            }
+        }
+        else if (arg == "-t" && has_value) {
+            // More workers than this only adds buffered blocks, and huge counts fail to spawn.
+            long max_threads = 4L * max(1u, thread::hardware_concurrency());
+            long threads = 0;
+            if (!parseInt(argv[++i], 0, max_threads, threads)) {
+                cerr << "Invalid thread count (0-" << max_threads << "): " << argv[i] << endl;
+                return 2;
+            }
+            options.threads = static_cast<unsigned>(threads);
+        }
+        else if (arg == "-f" && has_value) {
+            if (!parse_filter_chain(argv[++i], options.filters)) {
+                cerr << "Unknown filter chain: " << argv[i] << endl;
+                return 2;
+            }
+        }
+        else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "-" || arg[0] != '-') {
+            files.push_back(arg);
+        }
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (files.size() > 2) {
+        printUsage();
+        return 2;
+    }
+
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    ios::sync_with_stdio(false);
+
+    ifstream in_file;
+    ofstream out_file;
+    istream* in = &cin;
+    ostream* out = &cout;
+    if (files.size() > 0 && files[0] != "-") {
+        in_file.open(files[0], ios::binary);
+        if (!in_file) {
+            cerr << "Cannot open " << files[0] << endl;
+            return 1;
+        }
+        in = &in_file;
+    }
+    if (files.size() > 1 && files[1] != "-") {
+        out_file.open(files[1], ios::binary);
+        if (!out_file) {
+            cerr << "Cannot create " << files[1] << endl;
+            return 1;
+        }
+        out = &out_file;
+    }
+
+    bool ok = decompress ? pipeline_decompress(*in, *out, options.threads) : pipeline_compress(*in, *out, options);
+    if (!ok) {
+        cerr << (decompress ? "Decompression failed: corrupt input or write error" : "Compression failed: read or write error") << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Runs every codec over one file and prints the comparison table.
+int runComparison(const string& filename) {
     string text = readFile(filename);
 
     cout << "COMPRESSION ALGORITHMS TEST" << endl;
@@ -44,15 +220,50 @@ int main() {
 
     cout << string(97, '-') << endl;
 
-    CompressionResult r1 = litvinova_compress(text);
-    CompressionResult r2 = milyaeva_compress(text);
-    CompressionResult r3 = doni_compress(text);
-    CompressionResult r4 = kolesnikov_compress(text);
+    const function<CompressionResult(const string&)> codecs[] = {
+        litvinova_compress,
+        milyaeva_compress,
+        doni_compress,
+        kolesnikov_compress,
+        bwt_compress,
+        [](const string& input) { return auto_compress(input); },
+        [](const string& input) { return seekable_compress(input, CODEC_AUTO); },
+        [](const string& input) { return filtered_compress(input, { FILTER_COLUMNS, FILTER_DELTA }); },
+    };
+
+    vector<CompressionResult> results;
+    vector<string> stats;
+    for (const auto& compress : codecs) {
+        codec_stats_reset();
+        results.push_back(compress(text));
+        stats.push_back(codec_stats_json());
+    }
+
+    for (const auto& result : results) {
+        printResult(result);
+    }
 
-    printResult(r1);
-    printResult(r2);
-    printResult(r3);
-    printResult(r4);
+#ifdef SJATIE_STATS
+    cout << endl << "{" << endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << "  \"" << results[i].algorithm_name << "\": " << stats[i] << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    cout << "}" << endl;
+#endif
 
     return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && string(argv[1]) == "-r") {
+        for (int i = 2; i < argc; i++) {
+            if (i > 2) cout << endl;
+            runComparison(argv[i]);
+        }
+        return 0;
+    }
+    if (argc > 1) {
+        return runCli(argc, argv);
+    }
+    return runComparison("data6.txt");
 }
\ No newline at end of file
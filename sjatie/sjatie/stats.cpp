@@ -0,0 +1,68 @@
+#include "CodecStats.h"
+#include <iomanip>
+#include <sstream>
+
+static CodecStats stats;
+
+CodecStats& codec_stats() {
+    return stats;
+}
+
+static void resetHistogram(StatsHistogram& histogram) {
+    for (auto& bucket : histogram.buckets) bucket.store(0, std::memory_order_relaxed);
+}
+
+void codec_stats_reset() {
+    resetHistogram(stats.lz77_match_length);
+    resetHistogram(stats.lz77_match_offset);
+    stats.lz77_searches = 0;
+    stats.lz77_chain_steps = 0;
+    stats.lzw_calls = 0;
+    stats.lzw_codes = 0;
+    stats.lzw_dict_entries = 0;
+    stats.lzw_dict_full_events = 0;
+    stats.huffman_symbols = 0;
+    stats.huffman_code_bits = 0;
+    stats.huffman_entropy_millibits = 0;
+    resetHistogram(stats.rle_run_length);
+}
+
+// Histograms are printed as an array of bucket counts, bucket k = [2^(k-1), 2^k).
+static void writeHistogram(std::ostream& out, const StatsHistogram& histogram) {
+    out << "[";
+    for (int i = 0; i < STATS_HIST_BUCKETS; i++) {
+        if (i) out << ", ";
+        out << histogram.buckets[i].load();
+    }
+    out << "]";
+}
+
+static double ratio(uint64_t numerator, uint64_t denominator) {
+    return denominator ? static_cast<double>(numerator) / denominator : 0.0;
+}
+
+std::string codec_stats_json() {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{";
+    out << "\"lz77\": {\"searches\": " << stats.lz77_searches.load();
+    out << ", \"avg_chain_steps\": " << ratio(stats.lz77_chain_steps, stats.lz77_searches);
+    out << ", \"match_length_log2_hist\": ";
+    writeHistogram(out, stats.lz77_match_length);
+    out << ", \"match_offset_log2_hist\": ";
+    writeHistogram(out, stats.lz77_match_offset);
+    out << "}, ";
+    out << "\"lzw\": {\"calls\": " << stats.lzw_calls.load();
+    out << ", \"codes\": " << stats.lzw_codes.load();
+    out << ", \"avg_dict_fill\": " << ratio(stats.lzw_dict_entries, stats.lzw_calls);
+    out << ", \"dict_full_events\": " << stats.lzw_dict_full_events.load();
+    out << "}, ";
+    out << "\"huffman\": {\"symbols\": " << stats.huffman_symbols.load();
+    out << ", \"avg_code_length\": " << ratio(stats.huffman_code_bits, stats.huffman_symbols);
+    out << ", \"entropy\": " << ratio(stats.huffman_entropy_millibits, stats.huffman_symbols) / 1000.0;
+    out << "}, ";
+    out << "\"rle\": {\"run_length_log2_hist\": ";
+    writeHistogram(out, stats.rle_run_length);
+    out << "}}";
+    return out.str();
+}
\ No newline at end of file